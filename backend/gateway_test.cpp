@@ -0,0 +1,215 @@
+// Localhost round-trip check for the binary order gateway.
+// Starts an OrderGateway on a kernel-picked port and drives it with raw sockets.
+#include "order_gateway.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::cerr << "FAILED line " << __LINE__ << ": " #cond << std::endl; \
+            ++failures;                                                     \
+        }                                                                   \
+    } while (0)
+
+struct Frame {
+    GatewayMsgType type;
+    std::vector<char> payload;
+
+    template <typename Msg>
+    Msg as() const {
+        Msg msg{};
+        std::memcpy(&msg, payload.data(), (std::min)(sizeof(msg), payload.size()));
+        return msg;
+    }
+};
+
+static int connect_to(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+        throw std::runtime_error("connect failed");
+    }
+    timeval tv{2, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+template <typename Msg>
+static std::string frame(GatewayMsgType type, const Msg& msg) {
+    GatewayHeader header{static_cast<uint32_t>(sizeof(Msg)), static_cast<uint8_t>(type)};
+    std::string out(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(&msg), sizeof(msg));
+    return out;
+}
+
+static std::string new_order(int id, double price, unsigned int qty, uint8_t side,
+                             uint8_t type = 0) {
+    NewOrderMsg msg{id, price, qty, side, type, static_cast<int64_t>(std::time(nullptr))};
+    return frame(GatewayMsgType::NEW_ORDER, msg);
+}
+
+static std::string cancel(int id) {
+    return frame(GatewayMsgType::CANCEL, CancelMsg{id});
+}
+
+static void send_all(int fd, const std::string& bytes) {
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        ssize_t n = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) throw std::runtime_error("send failed");
+        sent += static_cast<size_t>(n);
+    }
+}
+
+static bool recv_exact(int fd, char* buf, size_t len) {
+    size_t got = 0;
+    while (got < len) {
+        ssize_t n = recv(fd, buf + got, len - got, 0);
+        if (n <= 0) return false;
+        got += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static Frame read_frame(int fd) {
+    GatewayHeader header{};
+    if (!recv_exact(fd, reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("timed out waiting for a frame");
+    }
+    Frame f{static_cast<GatewayMsgType>(header.msg_type), std::vector<char>(header.length)};
+    if (!recv_exact(fd, f.payload.data(), header.length)) {
+        throw std::runtime_error("truncated frame");
+    }
+    return f;
+}
+
+static void expect_reject(int fd, int order_id, GatewayRejectReason reason) {
+    Frame f = read_frame(fd);
+    CHECK(f.type == GatewayMsgType::REJECT);
+    RejectMsg reject = f.as<RejectMsg>();
+    CHECK(reject.order_id == order_id);
+    CHECK(reject.reason == static_cast<uint8_t>(reason));
+}
+
+int main() {
+    OrderBook book;
+    OrderGateway gateway(book, 0);
+    gateway.start();
+    std::cout << "Gateway test on port " << gateway.get_port() << std::endl;
+
+    int maker = connect_to(gateway.get_port());
+    int taker = connect_to(gateway.get_port());
+
+    try {
+        // Two resting sells in one write: two ACKs with no fills
+        send_all(maker, new_order(1, 101.0, 5, 0) + new_order(2, 102.0, 5, 0));
+        for (int id : {1, 2}) {
+            Frame ack = read_frame(maker);
+            CHECK(ack.type == GatewayMsgType::ACK);
+            CHECK(ack.as<AckMsg>().order_id == id);
+            CHECK(ack.as<AckMsg>().fill_count == 0);
+        }
+
+        // Aggressive buy split across three writes, mid-header and mid-payload
+        std::string buy = new_order(10, 102.0, 7, 1);
+        send_all(taker, buy.substr(0, 3));
+        usleep(20000);
+        send_all(taker, buy.substr(3, 10));
+        usleep(20000);
+        send_all(taker, buy.substr(13));
+
+        Frame ack = read_frame(taker);
+        CHECK(ack.type == GatewayMsgType::ACK);
+        CHECK(ack.as<AckMsg>().order_id == 10);
+        CHECK(ack.as<AckMsg>().fill_count == 2);
+        Frame fill1 = read_frame(taker);
+        Frame fill2 = read_frame(taker);
+        CHECK(fill1.type == GatewayMsgType::FILL && fill2.type == GatewayMsgType::FILL);
+        CHECK(fill1.as<FillMsg>().sell_order_id == 1 && fill1.as<FillMsg>().quantity == 5);
+        CHECK(fill1.as<FillMsg>().price == 101.0);
+        CHECK(fill2.as<FillMsg>().sell_order_id == 2 && fill2.as<FillMsg>().quantity == 2);
+
+        // The resting owner hears about both passive fills
+        Frame passive1 = read_frame(maker);
+        Frame passive2 = read_frame(maker);
+        CHECK(passive1.type == GatewayMsgType::FILL && passive1.as<FillMsg>().buy_order_id == 10);
+        CHECK(passive2.type == GatewayMsgType::FILL && passive2.as<FillMsg>().quantity == 2);
+
+        // Only the owner may cancel; a second cancel finds nothing
+        send_all(taker, cancel(2));
+        expect_reject(taker, 2, GatewayRejectReason::UNKNOWN_ORDER);
+        send_all(maker, cancel(2));
+        Frame cancel_ack = read_frame(maker);
+        CHECK(cancel_ack.type == GatewayMsgType::ACK && cancel_ack.as<AckMsg>().order_id == 2);
+        send_all(maker, cancel(2));
+        expect_reject(maker, 2, GatewayRejectReason::UNKNOWN_ORDER);
+
+        // Unknown type, wrong length, and out-of-range fields are rejected
+        GatewayHeader bogus{0, static_cast<uint8_t>('Z')};
+        send_all(taker, std::string(reinterpret_cast<const char*>(&bogus), sizeof(bogus)));
+        expect_reject(taker, -1, GatewayRejectReason::BAD_MESSAGE);
+        send_all(taker, frame(GatewayMsgType::NEW_ORDER, CancelMsg{11}));
+        expect_reject(taker, -1, GatewayRejectReason::BAD_MESSAGE);
+        send_all(taker, new_order(12, std::numeric_limits<double>::quiet_NaN(), 1, 1));
+        expect_reject(taker, 12, GatewayRejectReason::BAD_MESSAGE);
+        send_all(taker, new_order(13, -5.0, 1, 0));
+        expect_reject(taker, 13, GatewayRejectReason::BAD_MESSAGE);
+        send_all(taker, new_order(14, 100.0, 1, 7, 9));
+        expect_reject(taker, 14, GatewayRejectReason::BAD_MESSAGE);
+        send_all(taker, new_order(15, 100.0, 0, 1));
+        expect_reject(taker, 15, GatewayRejectReason::ZERO_QUANTITY);
+
+        // IDs are shared with gRPC AddOrder: a live UI order can't be overwritten
+        book.add_order(Order(20, 100.0, 5, false, std::time(nullptr)));
+        send_all(maker, new_order(20, 101.0, 5, 0));
+        expect_reject(maker, 20, GatewayRejectReason::DUPLICATE_ID);
+        send_all(taker, new_order(17, 101.0, 10, 1));
+        Frame cross_ack = read_frame(taker);
+        CHECK(cross_ack.type == GatewayMsgType::ACK && cross_ack.as<AckMsg>().fill_count == 1);
+        Frame cross_fill = read_frame(taker);
+        CHECK(cross_fill.as<FillMsg>().sell_order_id == 20 && cross_fill.as<FillMsg>().quantity == 5);
+        CHECK(cross_fill.as<FillMsg>().price == 100.0);
+        send_all(taker, cancel(17));
+        CHECK(read_frame(taker).type == GatewayMsgType::ACK);
+
+        // An order removed behind the gateway's back can't be cancelled again
+        send_all(maker, new_order(21, 105.0, 2, 0));
+        CHECK(read_frame(maker).type == GatewayMsgType::ACK);
+        book.remove_order(21);
+        send_all(maker, cancel(21));
+        expect_reject(maker, 21, GatewayRejectReason::UNKNOWN_ORDER);
+
+        // Disconnecting cancels the owner's resting orders
+        send_all(maker, new_order(3, 103.0, 4, 0));
+        CHECK(read_frame(maker).type == GatewayMsgType::ACK);
+        close(maker);
+        maker = -1;
+        usleep(200000);
+        send_all(taker, new_order(16, 103.0, 4, 1, 1));
+        Frame market_ack = read_frame(taker);
+        CHECK(market_ack.type == GatewayMsgType::ACK);
+        CHECK(market_ack.as<AckMsg>().fill_count == 0);
+    } catch (const std::exception& e) {
+        std::cerr << "FAILED: " << e.what() << std::endl;
+        ++failures;
+    }
+
+    if (maker != -1) close(maker);
+    close(taker);
+    gateway.stop();
+    std::cout << (failures == 0 ? "Gateway test passed" : "Gateway test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
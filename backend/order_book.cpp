@@ -107,7 +107,9 @@ void dr_msg_cb(rd_kafka_t *rk, const rd_kafka_message_t *rkmessage, void *opaque
 }
 
 // OrderBook implementation
-OrderBook::OrderBook() : _producer(nullptr), _conf(nullptr) {
+// 1s / 5s / 1m bars, 512 of each, rolling stats over the last 100 trades
+OrderBook::OrderBook()
+    : _aggregator({1000, 5000, 60000}, 512, 100), _producer(nullptr), _conf(nullptr) {
     char errstr[512];
     _conf = rd_kafka_conf_new();
     if (rd_kafka_conf_set(_conf, "bootstrap.servers", "127.0.0.1:9092",
@@ -232,14 +234,49 @@ void OrderBook::add_order_to_book(const Order& order) {
 }
 
 std::vector<Trade> OrderBook::add_order(const Order& order) {
+    std::vector<Trade> trades;
+    {
+        std::lock_guard<std::recursive_mutex> guard(_mutex);
+        trades = process_order(order, true);
+    }
+    // Outside the lock: this waits on every queued message, the gateway's included
+    rd_kafka_flush(_producer, 100);
+    return trades;
+}
+
+// Gateway hot path: no stdout, no per-order flush. Callers batch orders and
+// then call flush_events() once.
+std::vector<Trade> OrderBook::add_order_batched(const Order& order) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    return process_order(order, false);
+}
+
+void OrderBook::flush_events() {
+    // Non-blocking: serves delivery reports and hands queued trades to librdkafka
+    rd_kafka_flush(_producer, 0);
+}
+
+std::vector<Trade> OrderBook::process_order(const Order& order, bool verbose) {
+    // gRPC and the order gateway share one ID space; overwriting a resting
+    // (or expired, not yet pruned) order's lookup entry would strand it in the queue
+    if (_order_lookup.find(order.get_order_id()) != _order_lookup.end()) {
+        throw std::invalid_argument("Order " + std::to_string(order.get_order_id()) +
+                                    " is already resting in the book");
+    }
     if (order.is_expired()) {
-        std::cout << "Order " << order.get_order_id() << " is expired and will not be processed." << std::endl;
+        if (verbose) {
+            std::cout << "Order " << order.get_order_id() << " is expired and will not be processed." << std::endl;
+        }
         return {};
     }
     std::vector<Trade> trades = match_order(order);
+    int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
     for (const auto& trade : trades) {
+        if (_trade_log.size() == kTradeLogCapacity) _trade_log.pop_front();
         _trade_log.push_back(trade);
-        trade.repr();
+        _aggregator.on_trade(trade.price, trade.quantity, now_ms);
+        if (verbose) trade.repr();
         nlohmann::json trade_json = {
             {"buy_order_id", trade.buy_order_id},
             {"sell_order_id", trade.sell_order_id},
@@ -257,22 +294,33 @@ std::vector<Trade> OrderBook::add_order(const Order& order) {
                 RD_KAFKA_V_END) == -1) {
             std::cerr << "%% Failed to produce to topic " << "order-updates" << ": "
                       << rd_kafka_err2str(rd_kafka_last_error()) << std::endl;
-        } else {
+        } else if (verbose) {
             std::cout << "%% Enqueued message (" << trade_msg.size() << " bytes) for topic "
                       << "order-updates" << std::endl;
         }
-        rd_kafka_poll(_producer, 0);
+        if (verbose) rd_kafka_poll(_producer, 0);
     }
-    rd_kafka_flush(_producer, 100);
+    sample_quote();
     return trades;
 }
 
 void OrderBook::add_order_legacy(const Order& order) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     add_order_to_book(order);
+    sample_quote();
 }
 
 void OrderBook::remove_order(const int order_id) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     _order_lookup.erase(order_id);
+    sample_quote();
+}
+
+// True while the order is resting: not filled, cancelled or expired
+bool OrderBook::has_order(int order_id) const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    auto it = _order_lookup.find(order_id);
+    return it != _order_lookup.end() && !it->second->is_expired();
 }
 
 void OrderBook::clean_expired_orders() {
@@ -280,6 +328,7 @@ void OrderBook::clean_expired_orders() {
 }
 
 void OrderBook::repr() {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     std::vector<Order> current_buys, current_sells;
     auto temp_buy_queue = _buy_orders;
     while (!temp_buy_queue.empty()) {
@@ -312,6 +361,7 @@ void OrderBook::repr() {
 }
 
 void OrderBook::repr(bool side) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     if (side) {
         std::cout << "\nBuy Orders:\n";
         auto temp_buy_queue = _buy_orders;
@@ -340,6 +390,7 @@ void OrderBook::repr(bool side) {
 }
 
 Order OrderBook::get_best_bid() const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     if (!_buy_orders.empty()) {
         auto temp_queue = _buy_orders;
         while (!temp_queue.empty()) {
@@ -355,6 +406,7 @@ Order OrderBook::get_best_bid() const {
 }
 
 Order OrderBook::get_best_ask() const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     if (!_sell_orders.empty()) {
         auto temp_queue = _sell_orders;
         while (!temp_queue.empty()) {
@@ -371,30 +423,49 @@ Order OrderBook::get_best_ask() const {
 
 void OrderBook::update_order(int order_id, std::optional<double> new_price,
                   std::optional<unsigned int> new_qty, std::optional<bool> new_side) {
-    auto it = _order_lookup.find(order_id);
-    if (it == _order_lookup.end()) {
-        std::cout << "Order not found\n";
-        return;
-    }
-    Order updated_order = *it->second;
-    remove_order(order_id);
-    if (new_price.has_value()) {
-        updated_order.set_price(new_price.value());
-    }
-    if (new_qty.has_value()) {
-        updated_order.set_qty(new_qty.value());
-    }
-    if (new_side.has_value()) {
-        updated_order.set_side(new_side.value());
+    {
+        std::lock_guard<std::recursive_mutex> guard(_mutex);
+        auto it = _order_lookup.find(order_id);
+        if (it == _order_lookup.end()) {
+            std::cout << "Order not found\n";
+            return;
+        }
+        Order updated_order = *it->second;
+        // Not remove_order: the quote in between is never visible, so don't sample it
+        _order_lookup.erase(it);
+        if (new_price.has_value()) {
+            updated_order.set_price(new_price.value());
+        }
+        if (new_qty.has_value()) {
+            updated_order.set_qty(new_qty.value());
+        }
+        if (new_side.has_value()) {
+            updated_order.set_side(new_side.value());
+        }
+        process_order(updated_order, true);
     }
-    add_order(updated_order);
+    rd_kafka_flush(_producer, 100);
+}
+
+// A copy: the gateway thread keeps appending after the lock is released
+std::vector<Trade> OrderBook::get_trade_log() const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    return std::vector<Trade>(_trade_log.begin(), _trade_log.end());
+}
+
+// Locked copies, safe while the order gateway thread keeps trading
+std::vector<Candle> OrderBook::get_candles(int64_t interval_ms, size_t limit) const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    return _aggregator.get_candles(interval_ms).snapshot(limit);
 }
 
-const std::vector<Trade>& OrderBook::get_trade_log() const {
-    return _trade_log;
+MarketStats OrderBook::get_market_stats() const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    return _aggregator.get_stats();
 }
 
 void OrderBook::repr_trade_log() const {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
     std::cout << "\n=== Trade Log ===\n";
     for (const auto& trade : _trade_log) {
         trade.repr();
@@ -412,7 +483,45 @@ void OrderBook::flip_order(int order_id) {
     }
 }
 
+// Best limit price on one side without copying the queue (unlike get_best_bid/ask).
+// Pops cancelled/expired entries off the top the same way match_order does.
+std::optional<double> OrderBook::top_price(bool side) {
+    auto top_of = [this](auto& queue) -> std::optional<double> {
+        while (!queue.empty()) {
+            const Order& top = queue.top().first;
+            if (_order_lookup.find(top.get_order_id()) == _order_lookup.end()) {
+                queue.pop();
+                continue;
+            }
+            if (top.is_expired()) {
+                _order_lookup.erase(top.get_order_id());
+                queue.pop();
+                continue;
+            }
+            if (top.get_order_type() != OrderType::LIMIT) return std::nullopt;
+            return top.get_price();
+        }
+        return std::nullopt;
+    };
+    return side ? top_of(_buy_orders) : top_of(_sell_orders);
+}
+
+// Feeds the spread window only when the best bid or ask actually moved, so
+// the mean spread is over quote changes rather than order submissions
+void OrderBook::sample_quote() {
+    std::optional<double> bid = top_price(true);
+    std::optional<double> ask = top_price(false);
+    if (bid == _quoted_bid && ask == _quoted_ask) return;
+    _quoted_bid = bid;
+    _quoted_ask = ask;
+    if (bid.has_value() && ask.has_value()) {
+        _aggregator.on_quote(bid.value(), ask.value());
+    }
+}
+
 // Example usage (for standalone testing only)
+// Targets that bring their own main (e.g. gateway_test) define ORDER_BOOK_NO_MAIN
+#ifndef ORDER_BOOK_NO_MAIN
 int main() {
     OrderBook book;
     Order limit_buy(1, 100.0, 10, true, std::time(nullptr), OrderType::LIMIT);
@@ -468,3 +577,4 @@ int main() {
     book.repr_trade_log();
     return 0;
 }
+#endif
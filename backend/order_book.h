@@ -13,12 +13,16 @@
 #include <optional>
 #include <vector>
 #include <queue>
+#include <deque>
 #include <chrono>
 #include <thread>
+#include <mutex>
 
 #include <librdkafka/rdkafka.h>
 #include <nlohmann/json.hpp>
 
+#include "trade_aggregator.h"
+
 // Forward declarations
 class Order;
 class Trade;
@@ -92,8 +96,11 @@ public:
     ~OrderBook();
 
     std::vector<Trade> add_order(const Order& order);
+    std::vector<Trade> add_order_batched(const Order& order);
+    void flush_events();
     void add_order_legacy(const Order& order);
     void remove_order(const int order_id);
+    bool has_order(int order_id) const;
     void clean_expired_orders();
     void repr();
     void repr(bool side);
@@ -101,8 +108,10 @@ public:
     Order get_best_ask() const;
     void update_order(int order_id, std::optional<double> new_price,
                       std::optional<unsigned int> new_qty, std::optional<bool> new_side);
-    const std::vector<Trade>& get_trade_log() const;
+    std::vector<Trade> get_trade_log() const; // newest kTradeLogCapacity trades
     void repr_trade_log() const;
+    std::vector<Candle> get_candles(int64_t interval_ms, size_t limit) const;
+    MarketStats get_market_stats() const;
 
 private:
     std::priority_queue<std::pair<Order, std::chrono::time_point<std::chrono::steady_clock>>,
@@ -114,11 +123,24 @@ private:
                         , SellOrderComparator> _sell_orders;
 
     std::unordered_map<int, std::shared_ptr<Order>> _order_lookup;
-    std::vector<Trade> _trade_log;
+    // Bounded now that the gateway feeds it at wire speed; the aggregator and
+    // Kafka keep the full history
+    static constexpr size_t kTradeLogCapacity = 10000;
+    std::deque<Trade> _trade_log;
+    TradeAggregator _aggregator;
+    std::optional<double> _quoted_bid; // top of book at the last spread sample
+    std::optional<double> _quoted_ask;
     rd_kafka_t *_producer;
     rd_kafka_conf_t *_conf;
+    // Shared by the gRPC service threads and the order gateway thread.
+    // Recursive so locked methods can call one another.
+    // Never held across rd_kafka_flush.
+    mutable std::recursive_mutex _mutex;
 
     std::vector<Trade> match_order(const Order& incoming_order);
+    std::vector<Trade> process_order(const Order& order, bool verbose);
     void add_order_to_book(const Order& order);
     void flip_order(int order_id);
+    std::optional<double> top_price(bool side);
+    void sample_quote();
 };
\ No newline at end of file
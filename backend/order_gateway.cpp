@@ -0,0 +1,401 @@
+#include "order_gateway.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+constexpr int kPollTimeoutMs = 100;
+constexpr size_t kReadChunk = 64 * 1024;
+constexpr int kMaxReadsPerTurn = 4;              // per connection per loop pass, for fairness
+constexpr uint32_t kMaxPayload = 1024;           // anything larger is garbage, drop the client
+constexpr size_t kOutHighWater = 1024 * 1024;    // stop reading from a client this far behind
+constexpr size_t kMaxOutBuf = 8 * 1024 * 1024;   // passive fills past this drop the client
+
+void set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+        throw std::runtime_error(std::string("fcntl failed: ") + std::strerror(errno));
+    }
+}
+
+} // namespace
+
+OrderGateway::OrderGateway(OrderBook& book, uint16_t port)
+    : _book(book), _port(port), _listen_fd(-1), _epoll_fd(-1), _running(false),
+      _scratch(kReadChunk) {
+    _listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_listen_fd == -1) {
+        throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno));
+    }
+    int one = 1;
+    setsockopt(_listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1 ||
+        listen(_listen_fd, SOMAXCONN) == -1) {
+        int err = errno;
+        close(_listen_fd);
+        throw std::runtime_error(std::string("bind/listen failed: ") + std::strerror(err));
+    }
+    // Port 0 lets the kernel pick one; read it back so callers can connect
+    socklen_t len = sizeof(addr);
+    getsockname(_listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    _port = ntohs(addr.sin_port);
+    set_nonblocking(_listen_fd);
+
+    _epoll_fd = epoll_create1(0);
+    if (_epoll_fd == -1) {
+        int err = errno;
+        close(_listen_fd);
+        throw std::runtime_error(std::string("epoll_create1 failed: ") + std::strerror(err));
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = _listen_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _listen_fd, &ev);
+}
+
+OrderGateway::~OrderGateway() {
+    stop();
+    for (auto& entry : _connections) {
+        close(entry.first);
+    }
+    if (_epoll_fd != -1) close(_epoll_fd);
+    if (_listen_fd != -1) close(_listen_fd);
+}
+
+uint16_t OrderGateway::get_port() const { return _port; }
+
+void OrderGateway::start() {
+    if (_thread.joinable()) return;
+    _running = true;
+    _thread = std::thread(&OrderGateway::event_loop, this);
+}
+
+void OrderGateway::run() {
+    _running = true;
+    event_loop();
+}
+
+void OrderGateway::stop() {
+    _running = false;
+    if (_thread.joinable() && _thread.get_id() != std::this_thread::get_id()) {
+        _thread.join();
+    }
+}
+
+void OrderGateway::event_loop() {
+    epoll_event events[kMaxEvents];
+    while (_running) {
+        // Don't sleep while some connection still has unread input
+        int timeout = _ready.empty() ? kPollTimeoutMs : 0;
+        int n = epoll_wait(_epoll_fd, events, kMaxEvents, timeout);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            std::cerr << "Gateway epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == _listen_fd) {
+                accept_connections();
+                continue;
+            }
+            auto it = _connections.find(fd);
+            if (it == _connections.end()) continue; // closed earlier in this batch
+            Connection& conn = it->second;
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                close_connection(fd);
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                conn.readable = true;
+            }
+            if ((events[i].events & EPOLLOUT) && !flush_to(conn)) {
+                close_connection(fd);
+                continue;
+            }
+            // Also resumes a paused client once EPOLLOUT has drained its replies
+            if (conn.readable) schedule(conn);
+        }
+
+        // One turn per ready connection so a client that never stops sending
+        // can't hold the loop; leftovers go round again without sleeping
+        std::vector<int> ready;
+        ready.swap(_ready);
+        for (int fd : ready) {
+            auto it = _connections.find(fd);
+            if (it == _connections.end()) continue;
+            Connection& conn = it->second;
+            conn.scheduled = false;
+            if (!service(conn)) {
+                close_connection(fd);
+                continue;
+            }
+            if (conn.readable && conn.out_buf.size() - conn.out_offset < kOutHighWater) {
+                schedule(conn);
+            }
+        }
+
+        // Fills for resting orders can land on connections that had no event
+        for (int fd : _pending_flush) {
+            auto it = _connections.find(fd);
+            if (it == _connections.end()) continue;
+            if (!flush_to(it->second)) {
+                close_connection(fd);
+            } else if (it->second.out_buf.size() - it->second.out_offset > kMaxOutBuf) {
+                std::cerr << "Gateway dropping fd " << fd << ": not reading its fills" << std::endl;
+                close_connection(fd);
+            }
+        }
+        _pending_flush.clear();
+
+        if (!ready.empty()) {
+            _book.flush_events();
+        }
+    }
+}
+
+void OrderGateway::accept_connections() {
+    while (true) {
+        int fd = accept(_listen_fd, nullptr, nullptr);
+        if (fd == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            std::cerr << "Gateway accept failed: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        set_nonblocking(fd);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = fd;
+        if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            close(fd);
+            continue;
+        }
+        Connection conn;
+        conn.fd = fd;
+        _connections.emplace(fd, std::move(conn));
+    }
+}
+
+void OrderGateway::schedule(Connection& conn) {
+    if (conn.scheduled) return;
+    conn.scheduled = true;
+    _ready.push_back(conn.fd);
+}
+
+// Reads up to kMaxReadsPerTurn chunks, handling frames after each one, then
+// flushes the replies in one write. Edge-triggered, so `readable` stays set
+// until recv reports EAGAIN. Returns false if the connection should close.
+bool OrderGateway::service(Connection& conn) {
+    if (conn.out_buf.size() - conn.out_offset >= kOutHighWater) {
+        return true; // paused until EPOLLOUT drains the backlog
+    }
+    for (int reads = 0; reads < kMaxReadsPerTurn; ) {
+        ssize_t got = recv(conn.fd, _scratch.data(), _scratch.size(), 0);
+        if (got > 0) {
+            conn.in_buf.insert(conn.in_buf.end(), _scratch.data(), _scratch.data() + got);
+            if (!process_frames(conn)) return false;
+            ++reads;
+            if (conn.out_buf.size() - conn.out_offset >= kOutHighWater) break;
+            continue;
+        }
+        if (got == 0) {
+            // Peer closed; send what we owe it, then drop the connection
+            conn.readable = false;
+            flush_to(conn);
+            return false;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            conn.readable = false;
+            break;
+        }
+        return false;
+    }
+    return flush_to(conn);
+}
+
+bool OrderGateway::flush_to(Connection& conn) {
+    while (conn.out_offset < conn.out_buf.size()) {
+        ssize_t sent = send(conn.fd, conn.out_buf.data() + conn.out_offset,
+                            conn.out_buf.size() - conn.out_offset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn.out_offset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent == -1 && errno == EINTR) continue;
+        // Socket full: EPOLLOUT will fire once it drains
+        return sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+    conn.out_buf.clear();
+    conn.out_offset = 0;
+    return true;
+}
+
+// Returns false if the stream is corrupt and the client should be dropped
+bool OrderGateway::process_frames(Connection& conn) {
+    size_t offset = 0;
+    const size_t available = conn.in_buf.size();
+    while (available - offset >= sizeof(GatewayHeader)) {
+        GatewayHeader header;
+        std::memcpy(&header, conn.in_buf.data() + offset, sizeof(header));
+        if (header.length > kMaxPayload) {
+            // Framing is lost; nothing after this can be trusted
+            std::cerr << "Gateway dropping fd " << conn.fd << ": frame of "
+                      << header.length << " bytes" << std::endl;
+            conn.in_buf.clear();
+            return false;
+        }
+        if (available - offset < sizeof(header) + header.length) break;
+        const char* payload = conn.in_buf.data() + offset + sizeof(header);
+
+        auto type = static_cast<GatewayMsgType>(header.msg_type);
+        if (type == GatewayMsgType::NEW_ORDER && header.length == sizeof(NewOrderMsg)) {
+            NewOrderMsg msg;
+            std::memcpy(&msg, payload, sizeof(msg));
+            handle_new_order(conn, msg);
+        } else if (type == GatewayMsgType::CANCEL && header.length == sizeof(CancelMsg)) {
+            CancelMsg msg;
+            std::memcpy(&msg, payload, sizeof(msg));
+            handle_cancel(conn, msg);
+        } else {
+            RejectMsg reject{-1, static_cast<uint8_t>(GatewayRejectReason::BAD_MESSAGE)};
+            append_frame(conn, GatewayMsgType::REJECT, reject);
+        }
+        offset += sizeof(header) + header.length;
+    }
+    // Keep any partial frame (at most header + kMaxPayload bytes) for the next read
+    conn.in_buf.erase(conn.in_buf.begin(), conn.in_buf.begin() + offset);
+    return true;
+}
+
+void OrderGateway::handle_new_order(Connection& conn, const NewOrderMsg& msg) {
+    // A NaN price would also break the comparators' ordering inside the book
+    bool valid = (msg.side == 0 || msg.side == 1) &&
+                 (msg.order_type == 0 || msg.order_type == 1);
+    if (valid && msg.order_type == 0) {
+        valid = std::isfinite(msg.price) && msg.price > 0.0;
+    }
+    if (!valid) {
+        RejectMsg reject{msg.order_id, static_cast<uint8_t>(GatewayRejectReason::BAD_MESSAGE)};
+        append_frame(conn, GatewayMsgType::REJECT, reject);
+        return;
+    }
+    if (msg.quantity == 0) {
+        RejectMsg reject{msg.order_id, static_cast<uint8_t>(GatewayRejectReason::ZERO_QUANTITY)};
+        append_frame(conn, GatewayMsgType::REJECT, reject);
+        return;
+    }
+    bool side = msg.side == 1;
+    OrderType type = msg.order_type == 1 ? OrderType::MARKET : OrderType::LIMIT;
+    // Market orders never rest, so their price is ignored
+    double price = type == OrderType::LIMIT ? msg.price : 0.0;
+    Order order(msg.order_id, price, msg.quantity, side,
+                static_cast<std::time_t>(msg.timestamp), type);
+    std::vector<Trade> trades;
+    try {
+        // The book checks the ID under its own lock, so a gRPC order can't slip in between
+        trades = _book.add_order_batched(order);
+    } catch (const std::invalid_argument&) {
+        RejectMsg reject{msg.order_id, static_cast<uint8_t>(GatewayRejectReason::DUPLICATE_ID)};
+        append_frame(conn, GatewayMsgType::REJECT, reject);
+        return;
+    }
+    // Anything still filed under this ID left the book some other way
+    _owned_orders.erase(msg.order_id);
+
+    AckMsg ack{msg.order_id, static_cast<uint32_t>(trades.size())};
+    append_frame(conn, GatewayMsgType::ACK, ack);
+
+    unsigned int filled = 0;
+    for (const auto& trade : trades) {
+        FillMsg fill{trade.buy_order_id, trade.sell_order_id, trade.price, trade.quantity};
+        append_frame(conn, GatewayMsgType::FILL, fill);
+        filled += trade.quantity;
+        int resting_id = side ? trade.sell_order_id : trade.buy_order_id;
+        notify_resting_owner(resting_id, conn.fd, fill);
+    }
+    // Mirror match_order: only limit orders rest with their leftover quantity
+    if (type == OrderType::LIMIT && filled < msg.quantity) {
+        _owned_orders[msg.order_id] = OwnedOrder{conn.fd, msg.quantity - filled};
+    }
+}
+
+void OrderGateway::handle_cancel(Connection& conn, const CancelMsg& msg) {
+    auto it = _owned_orders.find(msg.order_id);
+    if (it != _owned_orders.end() && !_book.has_order(msg.order_id)) {
+        // Removed or expired outside the gateway (e.g. through the Python bindings)
+        _owned_orders.erase(it);
+        it = _owned_orders.end();
+    }
+    if (it == _owned_orders.end() || it->second.fd != conn.fd) {
+        RejectMsg reject{msg.order_id, static_cast<uint8_t>(GatewayRejectReason::UNKNOWN_ORDER)};
+        append_frame(conn, GatewayMsgType::REJECT, reject);
+        return;
+    }
+    _book.remove_order(msg.order_id);
+    _owned_orders.erase(it);
+    AckMsg ack{msg.order_id, 0};
+    append_frame(conn, GatewayMsgType::ACK, ack);
+}
+
+void OrderGateway::notify_resting_owner(int order_id, int submitter_fd, const FillMsg& fill) {
+    auto it = _owned_orders.find(order_id);
+    if (it == _owned_orders.end()) return; // not entered through this gateway
+    int owner_fd = it->second.fd;
+    if (fill.quantity >= it->second.remaining) {
+        _owned_orders.erase(it);
+    } else {
+        it->second.remaining -= fill.quantity;
+    }
+    if (owner_fd == submitter_fd) return;
+    auto conn_it = _connections.find(owner_fd);
+    if (conn_it == _connections.end()) return;
+    append_frame(conn_it->second, GatewayMsgType::FILL, fill);
+    _pending_flush.push_back(owner_fd);
+}
+
+void OrderGateway::close_connection(int fd) {
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    _connections.erase(fd);
+    // Cancel on disconnect: nobody could cancel or hear about these orders otherwise
+    for (auto it = _owned_orders.begin(); it != _owned_orders.end(); ) {
+        if (it->second.fd == fd) {
+            _book.remove_order(it->first);
+            it = _owned_orders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template <typename Msg>
+void OrderGateway::append_frame(Connection& conn, GatewayMsgType type, const Msg& msg) {
+    GatewayHeader header{static_cast<uint32_t>(sizeof(Msg)), static_cast<uint8_t>(type)};
+    const char* h = reinterpret_cast<const char*>(&header);
+    const char* m = reinterpret_cast<const char*>(&msg);
+    conn.out_buf.insert(conn.out_buf.end(), h, h + sizeof(header));
+    conn.out_buf.insert(conn.out_buf.end(), m, m + sizeof(msg));
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+
+#include "order_book.h"
+
+/*
+    Binary order-entry gateway.
+
+    Every frame on the wire is a GatewayHeader followed by `length` bytes of
+    payload. All integers are little-endian (host order on x86, which is all
+    we run on) and structs are packed, so clients can write them straight
+    from a C struct or Python's struct module ("<IB" for the header).
+
+    Client -> gateway : NEW_ORDER, CANCEL
+    Gateway -> client : ACK, REJECT, FILL
+
+    A client may pipeline as many frames as it likes in one write. The
+    gateway handles every complete frame after each read and answers with
+    a single write per batch. Fills are sent to the submitter and, if it is
+    connected to this gateway, to the owner of the resting order.
+
+    NEW_ORDER is rejected with BAD_MESSAGE unless side and order_type are
+    0 or 1 and, for LIMIT orders, price is finite and positive. Order IDs
+    share one space with gRPC AddOrder: an ID still resting in the book,
+    whoever entered it, is rejected with DUPLICATE_ID.
+
+    Resting orders belong to the connection that entered them and are
+    cancelled when it disconnects. A client that stops reading is paused
+    once its unsent replies pass a high-water mark, and dropped if passive
+    fills push them past a hard limit.
+
+    The gateway shares the OrderBook with the gRPC service (OrderBook locks
+    internally); start() runs the event loop on its own thread.
+*/
+
+enum class GatewayMsgType : uint8_t {
+    NEW_ORDER = 'N',
+    CANCEL    = 'X',
+    ACK       = 'A',
+    REJECT    = 'R',
+    FILL      = 'F'
+};
+
+#pragma pack(push, 1)
+struct GatewayHeader {
+    uint32_t length;   // payload bytes following this header
+    uint8_t  msg_type; // GatewayMsgType
+};
+
+struct NewOrderMsg {
+    int32_t  order_id;
+    double   price;
+    uint32_t quantity;
+    uint8_t  side;       // 1 = Buy, 0 = Sell
+    uint8_t  order_type; // 0 = LIMIT, 1 = MARKET
+    int64_t  timestamp;
+};
+
+struct CancelMsg {
+    int32_t order_id;
+};
+
+struct AckMsg {
+    int32_t  order_id;
+    uint32_t fill_count; // number of FILL frames that follow for this order
+};
+
+struct RejectMsg {
+    int32_t order_id;
+    uint8_t reason; // GatewayRejectReason
+};
+
+struct FillMsg {
+    int32_t  buy_order_id;
+    int32_t  sell_order_id;
+    double   price;
+    uint32_t quantity;
+};
+#pragma pack(pop)
+
+enum class GatewayRejectReason : uint8_t {
+    BAD_MESSAGE   = 1,
+    DUPLICATE_ID  = 2,
+    UNKNOWN_ORDER = 3,
+    ZERO_QUANTITY = 4
+};
+
+class OrderGateway {
+public:
+    OrderGateway(OrderBook& book, uint16_t port);
+    ~OrderGateway();
+
+    void start(); // runs run() on a background thread
+    void run();   // blocks until stop() is called
+    void stop();  // also joins the thread started by start()
+    uint16_t get_port() const;
+
+private:
+    struct OwnedOrder {
+        int fd;
+        unsigned int remaining; // resting quantity, dropped when it hits zero
+    };
+
+    struct Connection {
+        int fd;
+        std::vector<char> in_buf;  // at most one partial frame between reads
+        std::vector<char> out_buf;
+        size_t out_offset = 0;
+        bool readable = false;     // socket may still hold unread data
+        bool scheduled = false;    // queued in _ready
+    };
+
+    OrderBook& _book;
+    uint16_t _port;
+    int _listen_fd;
+    int _epoll_fd;
+    std::atomic<bool> _running;
+    std::thread _thread;
+    std::vector<char> _scratch; // fixed read buffer shared by all connections
+    std::unordered_map<int, Connection> _connections;
+    std::unordered_map<int, OwnedOrder> _owned_orders; // resting gateway orders by order_id
+    std::vector<int> _ready;         // connections with input left to service
+    std::vector<int> _pending_flush; // connections that got passive fills this batch
+
+    void event_loop();
+    void accept_connections();
+    void schedule(Connection& conn);
+    bool service(Connection& conn);
+    bool flush_to(Connection& conn);
+    bool process_frames(Connection& conn);
+    void handle_new_order(Connection& conn, const NewOrderMsg& msg);
+    void handle_cancel(Connection& conn, const CancelMsg& msg);
+    void notify_resting_owner(int order_id, int submitter_fd, const FillMsg& fill);
+    void close_connection(int fd);
+
+    template <typename Msg>
+    static void append_frame(Connection& conn, GatewayMsgType type, const Msg& msg);
+};
@@ -0,0 +1,142 @@
+#include "trade_aggregator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// CandleSeries implementation
+CandleSeries::CandleSeries(int64_t interval_ms, size_t capacity)
+    : _interval_ms(interval_ms), _head(0), _size(0),
+      _start(capacity, 0), _open(capacity, 0.0), _high(capacity, 0.0),
+      _low(capacity, 0.0), _close(capacity, 0.0), _volume(capacity, 0.0) {
+    if (interval_ms <= 0 || capacity == 0) {
+        throw std::invalid_argument("CandleSeries needs a positive interval and capacity");
+    }
+}
+
+void CandleSeries::on_trade(double price, unsigned int qty, int64_t ts_ms) {
+    int64_t bucket = ts_ms - ts_ms % _interval_ms;
+    // A late trade (bucket already closed) is folded into the current bar
+    if (_size == 0 || bucket > _start[_head]) {
+        if (_size > 0) {
+            _head = (_head + 1) % _start.size();
+        }
+        _size = (std::min)(_size + 1, _start.size());
+        _start[_head] = bucket;
+        _open[_head] = price;
+        _high[_head] = price;
+        _low[_head] = price;
+        _close[_head] = price;
+        _volume[_head] = qty;
+        return;
+    }
+    _high[_head] = (std::max)(_high[_head], price);
+    _low[_head] = (std::min)(_low[_head], price);
+    _close[_head] = price;
+    _volume[_head] += qty;
+}
+
+int64_t CandleSeries::get_interval_ms() const { return _interval_ms; }
+size_t CandleSeries::capacity() const { return _start.size(); }
+size_t CandleSeries::size() const { return _size; }
+size_t CandleSeries::head() const { return _head; }
+
+std::vector<Candle> CandleSeries::snapshot(size_t limit) const {
+    size_t count = (std::min)(limit, _size);
+    std::vector<Candle> bars;
+    bars.reserve(count);
+    size_t cap = _start.size();
+    for (size_t i = count; i > 0; --i) {
+        size_t slot = (_head + cap - (i - 1)) % cap;
+        bars.push_back(Candle{_start[slot], _open[slot], _high[slot], _low[slot],
+                              _close[slot], _volume[slot]});
+    }
+    return bars;
+}
+
+const int64_t* CandleSeries::start_data() const { return _start.data(); }
+const double* CandleSeries::open_data() const { return _open.data(); }
+const double* CandleSeries::high_data() const { return _high.data(); }
+const double* CandleSeries::low_data() const { return _low.data(); }
+const double* CandleSeries::close_data() const { return _close.data(); }
+const double* CandleSeries::volume_data() const { return _volume.data(); }
+
+// RollingWindow implementation
+RollingWindow::RollingWindow(size_t capacity)
+    : _samples(capacity, 0.0), _next(0), _size(0), _sum(0.0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("RollingWindow needs a positive capacity");
+    }
+}
+
+double RollingWindow::push(double value) {
+    double evicted = _size == _samples.size() ? _samples[_next] : 0.0;
+    _sum += value - evicted;
+    _samples[_next] = value;
+    _next = (_next + 1) % _samples.size();
+    _size = (std::min)(_size + 1, _samples.size());
+    return evicted;
+}
+
+double RollingWindow::sum() const { return _sum; }
+double RollingWindow::last() const {
+    if (_size == 0) return 0.0;
+    return _samples[(_next + _samples.size() - 1) % _samples.size()];
+}
+size_t RollingWindow::size() const { return _size; }
+
+// TradeAggregator implementation
+TradeAggregator::TradeAggregator(const std::vector<int64_t>& intervals_ms, size_t bar_capacity,
+                                 size_t window_size)
+    : _notional(window_size), _volume(window_size), _spread(window_size),
+      _last_price(0.0), _total_volume(0), _trade_count(0) {
+    _series.reserve(intervals_ms.size());
+    for (int64_t interval : intervals_ms) {
+        _series.emplace_back(interval, bar_capacity);
+    }
+}
+
+void TradeAggregator::on_trade(double price, unsigned int qty, int64_t ts_ms) {
+    for (auto& series : _series) {
+        series.on_trade(price, qty, ts_ms);
+    }
+    _notional.push(price * qty);
+    _volume.push(qty);
+    _last_price = price;
+    _total_volume += qty;
+    ++_trade_count;
+}
+
+void TradeAggregator::on_quote(double best_bid, double best_ask) {
+    _spread.push(best_ask - best_bid);
+}
+
+const std::vector<CandleSeries>& TradeAggregator::get_series() const { return _series; }
+
+const CandleSeries& TradeAggregator::get_candles(int64_t interval_ms) const {
+    for (const auto& series : _series) {
+        if (series.get_interval_ms() == interval_ms) return series;
+    }
+    throw std::out_of_range("No candles kept for interval " + std::to_string(interval_ms) + "ms");
+}
+
+double TradeAggregator::get_last_price() const { return _last_price; }
+unsigned long long TradeAggregator::get_total_volume() const { return _total_volume; }
+unsigned long long TradeAggregator::get_trade_count() const { return _trade_count; }
+
+double TradeAggregator::get_rolling_vwap() const {
+    double volume = _volume.sum();
+    return volume > 0.0 ? _notional.sum() / volume : 0.0;
+}
+
+double TradeAggregator::get_rolling_volume() const { return _volume.sum(); }
+double TradeAggregator::get_last_spread() const { return _spread.last(); }
+
+double TradeAggregator::get_mean_spread() const {
+    return _spread.size() > 0 ? _spread.sum() / _spread.size() : 0.0;
+}
+
+MarketStats TradeAggregator::get_stats() const {
+    return MarketStats{_last_price, _total_volume, _trade_count, get_rolling_vwap(),
+                       get_rolling_volume(), get_last_spread(), get_mean_spread()};
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/*
+    Incremental market statistics fed by OrderBook fills.
+
+    CandleSeries keeps OHLCV bars for one interval in a fixed-size ring.
+    Columns are stored separately (struct of arrays), so a bar update
+    touches one slot per column and nothing is allocated per trade. Slot
+    `head` is the bar currently being built; bars older than `capacity`
+    are overwritten. Intervals with no trades produce no bar.
+
+    RollingWindow keeps the last N samples and their running sum so the
+    mean over the window is O(1) per update.
+
+    None of this is locked. The aggregator inside OrderBook is only read
+    through OrderBook::get_candles / get_market_stats, which return Candle
+    and MarketStats copies taken under the book's lock.
+*/
+
+struct Candle {
+    int64_t start; // epoch milliseconds
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+};
+
+struct MarketStats {
+    double last_price;
+    unsigned long long total_volume;
+    unsigned long long trade_count;
+    double rolling_vwap;
+    double rolling_volume;
+    double last_spread;
+    double mean_spread;
+};
+
+class CandleSeries {
+public:
+    CandleSeries(int64_t interval_ms, size_t capacity);
+
+    void on_trade(double price, unsigned int qty, int64_t ts_ms);
+
+    int64_t get_interval_ms() const;
+    size_t capacity() const;
+    size_t size() const;  // number of valid bars, <= capacity
+    size_t head() const;  // ring slot of the newest bar
+    std::vector<Candle> snapshot(size_t limit) const; // newest `limit` bars, oldest first
+
+    const int64_t* start_data() const;
+    const double* open_data() const;
+    const double* high_data() const;
+    const double* low_data() const;
+    const double* close_data() const;
+    const double* volume_data() const;
+
+private:
+    int64_t _interval_ms;
+    size_t _head;
+    size_t _size;
+    std::vector<int64_t> _start; // bar open time, epoch milliseconds
+    std::vector<double> _open;
+    std::vector<double> _high;
+    std::vector<double> _low;
+    std::vector<double> _close;
+    std::vector<double> _volume;
+};
+
+class RollingWindow {
+public:
+    explicit RollingWindow(size_t capacity);
+
+    // Returns the sample that fell out of the window, or 0 if none did
+    double push(double value);
+    double sum() const;
+    double last() const;
+    size_t size() const;
+
+private:
+    std::vector<double> _samples;
+    size_t _next;
+    size_t _size;
+    double _sum;
+};
+
+class TradeAggregator {
+public:
+    TradeAggregator(const std::vector<int64_t>& intervals_ms, size_t bar_capacity,
+                    size_t window_size);
+
+    void on_trade(double price, unsigned int qty, int64_t ts_ms);
+    // OrderBook calls this only when its best bid or ask changes
+    void on_quote(double best_bid, double best_ask);
+
+    const std::vector<CandleSeries>& get_series() const;
+    const CandleSeries& get_candles(int64_t interval_ms) const;
+
+    double get_last_price() const;
+    unsigned long long get_total_volume() const;
+    unsigned long long get_trade_count() const;
+    double get_rolling_vwap() const;   // over the last window_size trades
+    double get_rolling_volume() const; // over the last window_size trades
+    double get_last_spread() const;
+    double get_mean_spread() const;    // over the last window_size on_quote calls
+    MarketStats get_stats() const;
+
+private:
+    std::vector<CandleSeries> _series;
+    RollingWindow _notional;
+    RollingWindow _volume;
+    RollingWindow _spread;
+    double _last_price;
+    unsigned long long _total_volume;
+    unsigned long long _trade_count;
+};
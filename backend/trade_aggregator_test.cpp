@@ -0,0 +1,92 @@
+// Checks for the OHLCV rings and rolling windows behind OrderBook's market stats.
+// One 1s series with a 3-bar ring and a 2-sample window, so wrap and eviction show up early.
+#include "order_book.h"
+#include "trade_aggregator.h"
+
+#include <iostream>
+#include <stdexcept>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::cerr << "FAILED line " << __LINE__ << ": " #cond << std::endl; \
+            ++failures;                                                     \
+        }                                                                   \
+    } while (0)
+
+int main() {
+    TradeAggregator agg({1000}, 3, 2);
+    const CandleSeries& bars = agg.get_candles(1000);
+
+    // Trades in the same second share a bar
+    agg.on_trade(10.0, 1, 1500);
+    agg.on_trade(12.0, 2, 1900);
+    agg.on_trade(9.0, 1, 1999);
+    CHECK(bars.size() == 1 && bars.start_data()[0] == 1000);
+    CHECK(bars.open_data()[0] == 10.0 && bars.high_data()[0] == 12.0);
+    CHECK(bars.low_data()[0] == 9.0 && bars.close_data()[0] == 9.0);
+    CHECK(bars.volume_data()[0] == 4.0);
+
+    // Rollover opens the next slot
+    agg.on_trade(11.0, 1, 2500);
+    CHECK(bars.size() == 2 && bars.head() == 1 && bars.start_data()[1] == 2000);
+
+    // A late trade folds into the current bar instead of reopening an old one
+    agg.on_trade(20.0, 3, 1200);
+    CHECK(bars.size() == 2 && bars.start_data()[1] == 2000);
+    CHECK(bars.high_data()[1] == 20.0 && bars.close_data()[1] == 20.0);
+    CHECK(bars.volume_data()[1] == 4.0);
+
+    // Empty seconds produce no bar; the fourth bar overwrites the oldest slot
+    agg.on_trade(13.0, 1, 5000);
+    agg.on_trade(14.0, 1, 7000);
+    CHECK(bars.size() == 3 && bars.head() == 0 && bars.start_data()[0] == 7000);
+    std::vector<Candle> newest = bars.snapshot(3);
+    CHECK(newest.size() == 3);
+    CHECK(newest[0].start == 2000 && newest[1].start == 5000 && newest[2].start == 7000);
+    CHECK(bars.snapshot(1).size() == 1 && bars.snapshot(1)[0].start == 7000);
+    CHECK(bars.snapshot(10).size() == 3);
+
+    // The 2-trade window now holds 13 x 1 and 14 x 1
+    CHECK(agg.get_rolling_volume() == 2.0 && agg.get_rolling_vwap() == 13.5);
+    CHECK(agg.get_trade_count() == 7 && agg.get_total_volume() == 10);
+    CHECK(agg.get_last_price() == 14.0);
+
+    // Spreads 1, 3, 5: the window keeps 3 and 5
+    agg.on_quote(99.0, 100.0);
+    agg.on_quote(99.0, 102.0);
+    agg.on_quote(99.0, 104.0);
+    CHECK(agg.get_last_spread() == 5.0 && agg.get_mean_spread() == 4.0);
+
+    MarketStats stats = agg.get_stats();
+    CHECK(stats.rolling_vwap == 13.5 && stats.mean_spread == 4.0 && stats.trade_count == 7);
+
+    bool threw = false;
+    try {
+        agg.get_candles(5000);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    // The book samples the spread only when its best bid or ask moves
+    OrderBook book;
+    book.add_order(Order(1, 99.0, 5, true, std::time(nullptr)));   // one-sided, no spread
+    book.add_order(Order(2, 101.0, 5, false, std::time(nullptr))); // 99 / 101
+    book.add_order(Order(3, 105.0, 1, false, std::time(nullptr))); // behind the ask
+    book.add_order(Order(4, 98.0, 5, true, std::time(nullptr)));   // behind the bid
+    book.remove_order(3);                                           // not at the top
+    CHECK(book.get_market_stats().last_spread == 2.0);
+    CHECK(book.get_market_stats().mean_spread == 2.0);
+    book.add_order(Order(5, 105.0, 1, false, std::time(nullptr)));
+    book.remove_order(2);                                           // 99 / 105
+    book.update_order(4, 100.0, std::nullopt, std::nullopt);        // 100 / 105
+    MarketStats book_stats = book.get_market_stats();
+    CHECK(book_stats.last_spread == 5.0);
+    CHECK(book_stats.mean_spread == (2.0 + 6.0 + 5.0) / 3.0);
+
+    std::cout << (failures == 0 ? "TradeAggregator test passed" : "TradeAggregator test FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
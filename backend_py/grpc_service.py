@@ -1,5 +1,5 @@
 #grpc_service
-import time, json
+import os, time, json
 from concurrent import futures
 
 import grpc
@@ -17,6 +17,15 @@ class OrderBookService(my_service_pb2_grpc.OrderBookServiceServicer):
         self.kafka_producer = Producer({"bootstrap.servers":"localhost:9092"})
         self.trades = []  # Add this line
 
+        # Binary TCP order entry straight into self.book (see backend/order_gateway.h);
+        # orders from it match against UI orders. Linux builds only.
+        self.gateway = None
+        if hasattr(orderbook_cpp, "OrderGateway"):
+            port = int(os.environ.get("ORDER_GATEWAY_PORT", "9001"))
+            self.gateway = orderbook_cpp.OrderGateway(self.book, port)
+            self.gateway.start()
+            print(f"Order gateway listening on 0.0.0.0:{self.gateway.get_port()}")
+
     def AddOrder(self, req, ctx):
         # turn the protobuf into your C++ Order
         o = orderbook_cpp.Order(
@@ -27,8 +36,11 @@ class OrderBookService(my_service_pb2_grpc.OrderBookServiceServicer):
             req.timestamp,
             getattr(orderbook_cpp.OrderType, req.order_type)
         )
-        # call into C++
-        trades = self.book.add_order(o)
+        # call into C++; IDs are shared with the order gateway
+        try:
+            trades = self.book.add_order(o)
+        except ValueError as e:
+            ctx.abort(grpc.StatusCode.ALREADY_EXISTS, str(e))
 
         # Track in Python for visualization
         order_level = {"price": req.price, "quantity": req.quantity}
@@ -37,16 +49,15 @@ class OrderBookService(my_service_pb2_grpc.OrderBookServiceServicer):
         else:
             self.asks.append(order_level)
 
-        # When a trade is matched, append to self.trades:
-        trade = {
-            "timestamp": int(time.time()),
-            "price": req.price,
-            "quantity": req.quantity,
-            "side": req.side
-        }
-        self.trades.append(trade)
-
         for t in trades:
+            # Record the actual fill, side is the aggressor's
+            self.trades.append({
+                "timestamp": int(time.time()),
+                "price": t.price,
+                "quantity": t.quantity,
+                "side": req.side
+            })
+
             ts = int(t.timestamp.total_seconds())
             msg = {
               "buy_order_id":  t.buy_order_id,
@@ -134,10 +145,39 @@ class OrderBookService(my_service_pb2_grpc.OrderBookServiceServicer):
                 side=trade["side"]
             )
 
+    def GetCandles(self, req, ctx):
+        # Bars and stats come from the C++ aggregator, fed by every fill
+        # (gRPC and order gateway alike)
+        limit = req.limit or 1 << 31
+        try:
+            bars = self.book.get_candles(req.interval_ms or 1000, limit)
+        except IndexError as e:
+            ctx.abort(grpc.StatusCode.INVALID_ARGUMENT, str(e))
+        stats = self.book.get_market_stats()
+        return my_service_pb2.CandleResponse(
+            candles=[
+                my_service_pb2.Candle(
+                    start=b.start, open=b.open, high=b.high,
+                    low=b.low, close=b.close, volume=b.volume
+                )
+                for b in bars
+            ],
+            stats=my_service_pb2.MarketStats(
+                last_price=stats.last_price,
+                total_volume=stats.total_volume,
+                trade_count=stats.trade_count,
+                rolling_vwap=stats.rolling_vwap,
+                rolling_volume=stats.rolling_volume,
+                last_spread=stats.last_spread,
+                mean_spread=stats.mean_spread
+            )
+        )
+
 def serve():
     server = grpc.server(futures.ThreadPoolExecutor(max_workers=4))
+    service = OrderBookService()
     my_service_pb2_grpc.add_OrderBookServiceServicer_to_server(
-        OrderBookService(), server
+        service, server
     )
     server.add_insecure_port('[::]:50051')
     print("gRPC listening on 0.0.0.0:50051")
@@ -147,6 +187,8 @@ def serve():
             time.sleep(86400)
     except KeyboardInterrupt:
         server.stop(0)
+        if service.gateway:
+            service.gateway.stop()
 
 if __name__ == "__main__":
     serve()
@@ -110,5 +110,35 @@ def get_trades():
         for t in trades
     ]
 
+@app.get("/candles")
+def get_candles(interval_ms: int = 1000, limit: int = 100):
+    try:
+        resp = stub.GetCandles(my_service_pb2.CandleRequest(interval_ms=interval_ms, limit=limit))
+        return {
+            "candles": [
+                {
+                    "start": c.start,
+                    "open": c.open,
+                    "high": c.high,
+                    "low": c.low,
+                    "close": c.close,
+                    "volume": c.volume
+                }
+                for c in resp.candles
+            ],
+            "stats": {
+                "last_price": resp.stats.last_price,
+                "total_volume": resp.stats.total_volume,
+                "trade_count": resp.stats.trade_count,
+                "rolling_vwap": resp.stats.rolling_vwap,
+                "rolling_volume": resp.stats.rolling_volume,
+                "last_spread": resp.stats.last_spread,
+                "mean_spread": resp.stats.mean_spread
+            }
+        }
+    except Exception as e:
+        print(f"Error in get_candles: {e}")
+        return {"candles": [], "stats": None}
+
 if __name__ == "__main__":
     uvicorn.run(app, host="0.0.0.0", port=8000)
\ No newline at end of file
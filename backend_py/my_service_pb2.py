@@ -24,7 +24,7 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x10my_service.proto\"v\n\x0cOrderRequest\x12\x10\n\x08order_id\x18\x01 \x01(\x05\x12\r\n\x05price\x18\x02 \x01(\x01\x12\x10\n\x08quantity\x18\x03 \x01(\r\x12\x0c\n\x04side\x18\x04 \x01(\x08\x12\x11\n\ttimestamp\x18\x05 \x01(\x03\x12\x12\n\norder_type\x18\x06 \x01(\t\"w\n\rOrderResponse\x12\x10\n\x08order_id\x18\x01 \x01(\x05\x12\r\n\x05price\x18\x02 \x01(\x01\x12\x10\n\x08quantity\x18\x03 \x01(\r\x12\x0c\n\x04side\x18\x04 \x01(\x08\x12\x11\n\ttimestamp\x18\x05 \x01(\x03\x12\x12\n\norder_type\x18\x06 \x01(\t\"\x07\n\x05\x45mpty\"1\n\x0eOrderBookLevel\x12\r\n\x05price\x18\x01 \x01(\x01\x12\x10\n\x08quantity\x18\x02 \x01(\r\"Q\n\x11OrderBookResponse\x12\x1d\n\x04\x62ids\x18\x01 \x03(\x0b\x32\x0f.OrderBookLevel\x12\x1d\n\x04\x61sks\x18\x02 \x03(\x0b\x32\x0f.OrderBookLevel\"I\n\x05Trade\x12\x11\n\ttimestamp\x18\x01 \x01(\x03\x12\r\n\x05price\x18\x02 \x01(\x01\x12\x10\n\x08quantity\x18\x03 \x01(\r\x12\x0c\n\x04side\x18\x04 \x01(\x08\x32\xd6\x01\n\x10OrderBookService\x12)\n\x08\x41\x64\x64Order\x12\r.OrderRequest\x1a\x0e.OrderResponse\x12$\n\nGetBestBid\x12\x06.Empty\x1a\x0e.OrderResponse\x12$\n\nGetBestAsk\x12\x06.Empty\x1a\x0e.OrderResponse\x12*\n\x0cGetOrderBook\x12\x06.Empty\x1a\x12.OrderBookResponse\x12\x1f\n\x0bGetTradeLog\x12\x06.Empty\x1a\x06.Trade0\x01\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x10my_service.proto\"v\n\x0cOrderRequest\x12\x10\n\x08order_id\x18\x01 \x01(\x05\x12\r\n\x05price\x18\x02 \x01(\x01\x12\x10\n\x08quantity\x18\x03 \x01(\r\x12\x0c\n\x04side\x18\x04 \x01(\x08\x12\x11\n\ttimestamp\x18\x05 \x01(\x03\x12\x12\n\norder_type\x18\x06 \x01(\t\"w\n\rOrderResponse\x12\x10\n\x08order_id\x18\x01 \x01(\x05\x12\r\n\x05price\x18\x02 \x01(\x01\x12\x10\n\x08quantity\x18\x03 \x01(\r\x12\x0c\n\x04side\x18\x04 \x01(\x08\x12\x11\n\ttimestamp\x18\x05 \x01(\x03\x12\x12\n\norder_type\x18\x06 \x01(\t\"\x07\n\x05\x45mpty\"1\n\x0eOrderBookLevel\x12\r\n\x05price\x18\x01 \x01(\x01\x12\x10\n\x08quantity\x18\x02 \x01(\r\"Q\n\x11OrderBookResponse\x12\x1d\n\x04\x62ids\x18\x01 \x03(\x0b\x32\x0f.OrderBookLevel\x12\x1d\n\x04\x61sks\x18\x02 \x03(\x0b\x32\x0f.OrderBookLevel\"I\n\x05Trade\x12\x11\n\ttimestamp\x18\x01 \x01(\x03\x12\r\n\x05price\x18\x02 \x01(\x01\x12\x10\n\x08quantity\x18\x03 \x01(\r\x12\x0c\n\x04side\x18\x04 \x01(\x08\"3\n\rCandleRequest\x12\x13\n\x0binterval_ms\x18\x01 \x01(\x03\x12\r\n\x05limit\x18\x02 \x01(\r\"_\n\x06\x43\x61ndle\x12\r\n\x05start\x18\x01 \x01(\x03\x12\x0c\n\x04open\x18\x02 \x01(\x01\x12\x0c\n\x04high\x18\x03 \x01(\x01\x12\x0b\n\x03low\x18\x04 \x01(\x01\x12\r\n\x05\x63lose\x18\x05 \x01(\x01\x12\x0e\n\x06volume\x18\x06 \x01(\x01\"\xa4\x01\n\x0bMarketStats\x12\x12\n\nlast_price\x18\x01 \x01(\x01\x12\x14\n\x0ctotal_volume\x18\x02 \x01(\x04\x12\x13\n\x0btrade_count\x18\x03 \x01(\x04\x12\x14\n\x0crolling_vwap\x18\x04 \x01(\x01\x12\x16\n\x0erolling_volume\x18\x05 \x01(\x01\x12\x13\n\x0blast_spread\x18\x06 \x01(\x01\x12\x13\n\x0bmean_spread\x18\x07 \x01(\x01\"G\n\x0e\x43\x61ndleResponse\x12\x18\n\x07\x63\x61ndles\x18\x01 \x03(\x0b\x32\x07.Candle\x12\x1b\n\x05stats\x18\x02 \x01(\x0b\x32\x0c.MarketStats2\x85\x02\n\x10OrderBookService\x12)\n\x08\x41\x64\x64Order\x12\r.OrderRequest\x1a\x0e.OrderResponse\x12$\n\nGetBestBid\x12\x06.Empty\x1a\x0e.OrderResponse\x12$\n\nGetBestAsk\x12\x06.Empty\x1a\x0e.OrderResponse\x12*\n\x0cGetOrderBook\x12\x06.Empty\x1a\x12.OrderBookResponse\x12\x1f\n\x0bGetTradeLog\x12\x06.Empty\x1a\x06.Trade0\x01\x12-\n\nGetCandles\x12\x0e.CandleRequest\x1a\x0f.CandleResponseb\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
@@ -43,6 +43,14 @@ if not _descriptor._USE_C_DESCRIPTORS:
   _globals['_ORDERBOOKRESPONSE']._serialized_end=402
   _globals['_TRADE']._serialized_start=404
   _globals['_TRADE']._serialized_end=477
-  _globals['_ORDERBOOKSERVICE']._serialized_start=480
-  _globals['_ORDERBOOKSERVICE']._serialized_end=694
+  _globals['_CANDLEREQUEST']._serialized_start=479
+  _globals['_CANDLEREQUEST']._serialized_end=530
+  _globals['_CANDLE']._serialized_start=532
+  _globals['_CANDLE']._serialized_end=627
+  _globals['_MARKETSTATS']._serialized_start=630
+  _globals['_MARKETSTATS']._serialized_end=794
+  _globals['_CANDLERESPONSE']._serialized_start=796
+  _globals['_CANDLERESPONSE']._serialized_end=867
+  _globals['_ORDERBOOKSERVICE']._serialized_start=870
+  _globals['_ORDERBOOKSERVICE']._serialized_end=1131
 # @@protoc_insertion_point(module_scope)
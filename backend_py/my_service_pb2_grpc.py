@@ -59,6 +59,11 @@ class OrderBookServiceStub(object):
                 request_serializer=my__service__pb2.Empty.SerializeToString,
                 response_deserializer=my__service__pb2.Trade.FromString,
                 _registered_method=True)
+        self.GetCandles = channel.unary_unary(
+                '/OrderBookService/GetCandles',
+                request_serializer=my__service__pb2.CandleRequest.SerializeToString,
+                response_deserializer=my__service__pb2.CandleResponse.FromString,
+                _registered_method=True)
 
 
 class OrderBookServiceServicer(object):
@@ -94,6 +99,12 @@ class OrderBookServiceServicer(object):
         context.set_details('Method not implemented!')
         raise NotImplementedError('Method not implemented!')
 
+    def GetCandles(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
 
 def add_OrderBookServiceServicer_to_server(servicer, server):
     rpc_method_handlers = {
@@ -122,6 +133,11 @@ def add_OrderBookServiceServicer_to_server(servicer, server):
                     request_deserializer=my__service__pb2.Empty.FromString,
                     response_serializer=my__service__pb2.Trade.SerializeToString,
             ),
+            'GetCandles': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetCandles,
+                    request_deserializer=my__service__pb2.CandleRequest.FromString,
+                    response_serializer=my__service__pb2.CandleResponse.SerializeToString,
+            ),
     }
     generic_handler = grpc.method_handlers_generic_handler(
             'OrderBookService', rpc_method_handlers)
@@ -267,3 +283,30 @@ class OrderBookService(object):
             timeout,
             metadata,
             _registered_method=True)
+
+    @staticmethod
+    def GetCandles(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(
+            request,
+            target,
+            '/OrderBookService/GetCandles',
+            my__service__pb2.CandleRequest.SerializeToString,
+            my__service__pb2.CandleResponse.FromString,
+            options,
+            channel_credentials,
+            insecure,
+            call_credentials,
+            compression,
+            wait_for_ready,
+            timeout,
+            metadata,
+            _registered_method=True)
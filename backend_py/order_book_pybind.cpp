@@ -2,10 +2,24 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
 #include "../backend/order_book.h"
+#ifdef HAVE_ORDER_GATEWAY
+#include "../backend/order_gateway.h"
+#endif
 
 namespace py = pybind11;
 
+// One numpy column per OHLCV field, copied out of a locked snapshot so no
+// array ever points into the rings the gateway thread is writing
+template <typename T, typename Field>
+static py::array_t<T> candle_column(const std::vector<Candle>& bars, Field field) {
+    py::array_t<T> column(static_cast<py::ssize_t>(bars.size()));
+    T* out = column.mutable_data();
+    for (size_t i = 0; i < bars.size(); ++i) out[i] = bars[i].*field;
+    return column;
+}
+
 PYBIND11_MODULE(orderbook_cpp, m) {
     py::class_<Trade>(m, "Trade")
         .def_readonly("buy_order_id", &Trade::buy_order_id)
@@ -30,9 +44,26 @@ PYBIND11_MODULE(orderbook_cpp, m) {
         .def("is_expired", &Order::is_expired)
         .def("repr", &Order::repr);
 
+    py::class_<Candle>(m, "Candle")
+        .def_readonly("start", &Candle::start)
+        .def_readonly("open", &Candle::open)
+        .def_readonly("high", &Candle::high)
+        .def_readonly("low", &Candle::low)
+        .def_readonly("close", &Candle::close)
+        .def_readonly("volume", &Candle::volume);
+
+    py::class_<MarketStats>(m, "MarketStats")
+        .def_readonly("last_price", &MarketStats::last_price)
+        .def_readonly("total_volume", &MarketStats::total_volume)
+        .def_readonly("trade_count", &MarketStats::trade_count)
+        .def_readonly("rolling_vwap", &MarketStats::rolling_vwap)
+        .def_readonly("rolling_volume", &MarketStats::rolling_volume)
+        .def_readonly("last_spread", &MarketStats::last_spread)
+        .def_readonly("mean_spread", &MarketStats::mean_spread);
+
     py::class_<OrderBook>(m, "OrderBook")
         .def(py::init<>())
-        .def("add_order", &OrderBook::add_order)
+        .def("add_order", &OrderBook::add_order, py::call_guard<py::gil_scoped_release>())
         .def("add_order_legacy", &OrderBook::add_order_legacy)
         .def("remove_order", &OrderBook::remove_order)
         .def("clean_expired_orders", &OrderBook::clean_expired_orders)
@@ -41,6 +72,29 @@ PYBIND11_MODULE(orderbook_cpp, m) {
         .def("get_best_bid", &OrderBook::get_best_bid)
         .def("get_best_ask", &OrderBook::get_best_ask)
         .def("update_order", &OrderBook::update_order)
-        .def("get_trade_log", &OrderBook::get_trade_log, py::return_value_policy::reference_internal)
-        .def("repr_trade_log", &OrderBook::repr_trade_log);
+        .def("get_trade_log", &OrderBook::get_trade_log)
+        .def("repr_trade_log", &OrderBook::repr_trade_log)
+        .def("get_candles", &OrderBook::get_candles)
+        .def("get_candle_arrays", [](const OrderBook& book, int64_t interval_ms, size_t limit) {
+            std::vector<Candle> bars = book.get_candles(interval_ms, limit);
+            py::dict columns;
+            columns["start"] = candle_column<int64_t>(bars, &Candle::start);
+            columns["open"] = candle_column<double>(bars, &Candle::open);
+            columns["high"] = candle_column<double>(bars, &Candle::high);
+            columns["low"] = candle_column<double>(bars, &Candle::low);
+            columns["close"] = candle_column<double>(bars, &Candle::close);
+            columns["volume"] = candle_column<double>(bars, &Candle::volume);
+            return columns;
+        })
+        .def("get_market_stats", &OrderBook::get_market_stats);
+
+#ifdef HAVE_ORDER_GATEWAY
+    // Binary order entry into this same book; the event loop runs on its own
+    // C++ thread and never touches the GIL
+    py::class_<OrderGateway>(m, "OrderGateway")
+        .def(py::init<OrderBook&, uint16_t>(), py::keep_alive<1, 2>())
+        .def("start", &OrderGateway::start)
+        .def("stop", &OrderGateway::stop, py::call_guard<py::gil_scoped_release>())
+        .def("get_port", &OrderGateway::get_port);
+#endif
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 // Enhanced Order Book JavaScript
-let priceHistory = [];
-const MAX_HISTORY = 100;
+let candleHistory = [];
+const CANDLE_INTERVAL_MS = 1000;
+const MAX_CANDLES = 100;
 let depthChart = null;
 let connectionStatus = true;
 
@@ -100,6 +101,22 @@ async function fetchTrades() {
     }
 }
 
+// Bars and stats come from the C++ aggregator, so the chart doesn't rebuild from /trades
+async function fetchCandles() {
+    try {
+        const res = await fetch(`/candles?interval_ms=${CANDLE_INTERVAL_MS}&limit=${MAX_CANDLES}`);
+        if (!res.ok) throw new Error(`HTTP error! status: ${res.status}`);
+        const data = await res.json();
+        return {
+            candles: Array.isArray(data.candles) ? data.candles : [],
+            stats: data.stats || null
+        };
+    } catch (error) {
+        console.error('Error fetching candles:', error);
+        return { candles: [], stats: null };
+    }
+}
+
 // Update functions
 function updateBestPrices(data) {
     const bestBidEl = document.getElementById('bestBid');
@@ -127,9 +144,10 @@ function updateBestPrices(data) {
     updateLastUpdateTime();
 }
 
-function updateMarketStats(orderBookData, tradesData) {
+function updateMarketStats(orderBookData, stats) {
     const ordersCountEl = document.getElementById('ordersCount');
     const tradesCountEl = document.getElementById('tradesCount');
+    const vwapEl = document.getElementById('vwapValue');
     const activityBar = document.querySelector('.activity-bar');
     
     if (ordersCountEl) {
@@ -138,7 +156,12 @@ function updateMarketStats(orderBookData, tradesData) {
     }
     
     if (tradesCountEl) {
-        tradesCountEl.textContent = tradesData.length.toString();
+        tradesCountEl.textContent = stats ? stats.trade_count.toLocaleString() : '--';
+    }
+    
+    if (vwapEl) {
+        vwapEl.textContent = stats && stats.trade_count > 0 ?
+            `$${stats.rolling_vwap.toFixed(2)}` : '$--';
     }
     
     if (activityBar) {
@@ -155,13 +178,13 @@ function updatePerformanceChart() {
         window.performanceChart = new Chart(ctx, {
             type: 'line',
             data: {
-                labels: priceHistory.map(p => p.time),
+                labels: candleHistory.map(c => new Date(c.start).toLocaleTimeString()),
                 datasets: [
                     {
-                        label: 'Best Bid',
-                        data: priceHistory.map(p => p.bestBid),
-                        borderColor: '#00ff88',
-                        backgroundColor: 'rgba(0, 255, 136, 0.1)',
+                        label: 'Close',
+                        data: candleHistory.map(c => c.close),
+                        borderColor: '#00d4ff',
+                        backgroundColor: 'rgba(0, 212, 255, 0.1)',
                         tension: 0.4,
                         fill: false,
                         pointRadius: 2,
@@ -169,15 +192,26 @@ function updatePerformanceChart() {
                         borderWidth: 2,
                     },
                     {
-                        label: 'Best Ask',
-                        data: priceHistory.map(p => p.bestAsk),
+                        label: 'High',
+                        data: candleHistory.map(c => c.high),
+                        borderColor: '#00ff88',
+                        backgroundColor: 'rgba(0, 255, 136, 0.1)',
+                        tension: 0.4,
+                        fill: false,
+                        pointRadius: 0,
+                        pointHoverRadius: 4,
+                        borderWidth: 1,
+                    },
+                    {
+                        label: 'Low',
+                        data: candleHistory.map(c => c.low),
                         borderColor: '#ff3366',
                         backgroundColor: 'rgba(255, 51, 102, 0.1)',
                         tension: 0.4,
                         fill: false,
-                        pointRadius: 2,
-                        pointHoverRadius: 6,
-                        borderWidth: 2,
+                        pointRadius: 0,
+                        pointHoverRadius: 4,
+                        borderWidth: 1,
                     }
                 ]
             },
@@ -235,9 +269,10 @@ function updatePerformanceChart() {
             }
         });
     } else {
-        window.performanceChart.data.labels = priceHistory.map(p => p.time);
-        window.performanceChart.data.datasets[0].data = priceHistory.map(p => p.bestBid);
-        window.performanceChart.data.datasets[1].data = priceHistory.map(p => p.bestAsk);
+        window.performanceChart.data.labels = candleHistory.map(c => new Date(c.start).toLocaleTimeString());
+        window.performanceChart.data.datasets[0].data = candleHistory.map(c => c.close);
+        window.performanceChart.data.datasets[1].data = candleHistory.map(c => c.high);
+        window.performanceChart.data.datasets[2].data = candleHistory.map(c => c.low);
         window.performanceChart.update('none');
     }
 }
@@ -440,20 +475,6 @@ async function refreshBestPrices() {
     try {
         const data = await fetchBestPrices();
         updateBestPrices(data);
-        
-        // Update price history
-        const now = new Date().toLocaleTimeString();
-        if (data.best_bid || data.best_ask) {
-            priceHistory.push({
-                time: now,
-                bestBid: data.best_bid?.price || null,
-                bestAsk: data.best_ask?.price || null
-            });
-            
-            if (priceHistory.length > MAX_HISTORY) {
-                priceHistory.shift();
-            }
-        }
     } catch (error) {
         console.error('Error refreshing best prices:', error);
     }
@@ -481,16 +502,28 @@ async function refreshTape() {
     }
 }
 
+async function refreshCandles() {
+    try {
+        const data = await fetchCandles();
+        candleHistory = data.candles;
+        updatePerformanceChart();
+        return data.stats;
+    } catch (error) {
+        console.error('Error refreshing candles:', error);
+        return null;
+    }
+}
+
 async function refreshAllData() {
     try {
-        const [, orderBookData, tradesData] = await Promise.all([
+        const [, orderBookData, , stats] = await Promise.all([
             refreshBestPrices(),
             refreshDepthChart(),
-            refreshTape()
+            refreshTape(),
+            refreshCandles()
         ]);
         
-        updateMarketStats(orderBookData, tradesData);
-        updatePerformanceChart();
+        updateMarketStats(orderBookData, stats);
     } catch (error) {
         console.error('Error refreshing data:', error);
     }
@@ -640,6 +673,6 @@ window.OrderBookDashboard = {
     refreshBestPrices,
     refreshDepthChart,
     refreshTape,
-    priceHistory,
+    refreshCandles,
     showToast
 };
\ No newline at end of file
@@ -37,6 +37,17 @@ else
     echo "Warning: Order book executable not found"
 fi
 
+# Start the gRPC service; it owns the C++ order book and runs the binary
+# order gateway (port 9001) on that same book
+echo "Starting gRPC service and Order Gateway..."
+if [ -f "./backend_py/grpc_service.py" ]; then
+    (cd backend_py && PYTHONPATH=build python3 grpc_service.py) &
+    GRPC_SERVICE_PID=$!
+    echo "gRPC service started with PID: $GRPC_SERVICE_PID"
+else
+    echo "Warning: grpc_service.py not found"
+fi
+
 # Wait for gRPC server to initialize
 sleep 5
 
@@ -66,6 +77,7 @@ sleep 5
 
 # Start FastAPI application (foreground process)
 echo "Starting FastAPI Web Interface..."
+cd backend_py 2>/dev/null || true  # main.py, templates/ and static/ live here
 if [ -f "main.py" ]; then
     python3 -m uvicorn main:app --host 0.0.0.0 --port 8000
 else